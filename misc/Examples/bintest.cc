@@ -78,4 +78,18 @@ int main(void){
     cout << " " << bin_means[i];
   }
   cout << endl;
+  // The same with the streaming binner: values are added one by one.
+  StreamBinner binner("log",startEdge,endEdge,numberOfBins,"forward");
+  for(int j=0; j<numberOfValues; j++){
+    binner.add(x2[j],y[j]);
+  }
+  cout << "Streaming means (forward): ";
+  for(int i=0; i<numberOfBins;i++){
+    cout << " " << binner.binMean(i);
+  }
+  cout << endl << "Streaming variances: ";
+  for(int i=0; i<numberOfBins;i++){
+    cout << " " << binner.binVariance(i);
+  }
+  cout << endl;
 }
@@ -9,6 +9,13 @@ network.
 To compile:     g++ -O -Wall collapseIndices.cpp -o collapseIndices
 
 To run:         cat net.edg | ./collapseIndices > net_collapsed.edg
+
+If a file name is given as an argument, the node identifiers may be
+any words (e.g. 64-bit user IDs or names). They are numbered in the
+order in which they first appear, and the mapping is written to the
+file as lines "INDEX ID":
+
+                cat net.edg | ./collapseIndices net.ids > net_collapsed.edg
                                                  
 (net.edg is a file where each row contains the values EDGE TAIL EDGECHARACTERISTIC
 (EDGECHARACTERISTIC for example edge weight)
@@ -32,6 +39,15 @@ typedef SymmNet<EdgeData> NetType;
 
 int main(int argc, char* argv[]) {
 
+  if (argc > 1) {
+    NodeIds<std::string> ids;
+    std::auto_ptr<NetType> netPointer(readNetWithIds<NetType>(std::cin, ids));
+    std::ofstream idFile(argv[1]);
+    ids.write(idFile);
+    outputEdgesAndWeights(*netPointer);
+    return 0;
+  }
+
   std::auto_ptr<NetType> netPointer(readNet2<NetType>(1,0)); 
   NetType& net = *netPointer;  // Create a reference for easier handling of net.
 
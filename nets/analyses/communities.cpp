@@ -0,0 +1,57 @@
+/*  communities.cpp
+
+Reads a network from standard input and writes out its communities,
+found by maximizing the modularity (see nets/Louvain.H), as lines
+NODE COMMUNITY. The number of communities and the modularity are
+written to standard error. The same seed gives the same communities.
+
+To compile:     g++ -O -Wall communities.cpp -o communities
+                (add -fopenmp to use all cores)
+
+To run:         cat net.edg | ./communities 1234 > communities.txt
+                or, with resolution 0.5:
+                cat net.edg | ./communities 1234 0.5 > communities.txt
+
+(net.edg is a file where each row contains the values SOURCE DEST WEIGHT)
+
+*/
+
+#define NDEBUG // to turn assertions off
+
+#include <vector>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <cstdlib>
+#include "../../Containers.H"
+#include "../../Nets.H"
+#include "../../Randgens.H"
+#include "../NetExtras.H"
+#include "../Louvain.H"
+
+
+typedef float EdgeData;
+typedef SymmNet<EdgeData> NetType;
+
+
+int main(int argc, char* argv[]) {
+
+  if (argc < 1+1) {
+    std::cerr << "\nFunction call: ./communities seed [resolution] < net.edg\n\n";
+    exit(1);
+  }
+  const unsigned seed=atoi(argv[1]);
+  const double resolution=(argc > 2 ? atof(argv[2]) : 1.0);
+
+  std::auto_ptr<NetType> netPointer(readNet<EdgeData>());
+  NetType& net = *netPointer;
+
+  RandNumGen<> generator(seed);
+  Louvain<NetType> louvain(net, resolution);
+  louvain.run(generator);
+  louvain.write(std::cout);
+
+  std::cerr << louvain.numCommunities() << " communities in "
+	    << louvain.numLevels() << " levels, modularity "
+	    << louvain.modularity() << "\n";
+}
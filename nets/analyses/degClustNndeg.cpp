@@ -5,6 +5,7 @@
 
 
 To compile:     g++ -O -Wall degClustNndeg.cpp -o degClustNndeg
+                (add -fopenmp to use all cores)
 
 To run:         cat net.edg | degClustNndeg./  > degClustNndeg.txt
 
@@ -38,17 +39,14 @@ int main(void) {
   NetType& net = *netPointer;  // Create a reference for easier handling of net.
 
   
-  /* Average degree, max degree  */
-  size_t kmax = 0;
+  /* Degrees, clustering and nearest neighbor degrees in one pass. */
+  NetStatistics<NetType> stats(net);
+
   size_t degreesum=0;
-  for (size_t i=0; i<net.size(); ++i) { 
-    degreesum += net(i).size();
-    if (net(i).size() > kmax) {kmax = net(i).size();}
-  }
+  for (size_t i=0; i<net.size(); ++i) degreesum += stats.degree(i);
   std::cerr << "\nAverage degree in the network:  " <<  ((float) degreesum) / net.size() << "\n\n";
-  
 
-  outputDistributions2(net);
+  stats.writeNodes(std::cout, DEGREE | CLUSTERING | KNN, false, false);
   std::cerr << "\n\nPrinted out for each node i: \n";
   std::cerr << "column 1: degree k(i)\n";
   std::cerr << "column 2: clustering c(i) = (# triangles around i) / ( k*(k-1)/2 )  \n";
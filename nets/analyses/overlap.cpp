@@ -8,12 +8,18 @@ HEAD TAIL OVERLAP (third column containing the overlap for each edge).
 If run with option 0, the program outputs the real overlap value 
 between [0,1] for each edge. With option 1 it multiplies this value 
 by 10000 (this way, the numbers are safer to sort with a shell command
-than if the values are in decimal numbers).
+than if the values are in decimal numbers). If the second option is 1,
+the weighted overlap is written as a fourth column. If the third 
+option is 1, the edge betweenness is written as the last column 
+(shortest routes by number of edges; see nets/Betweenness.H). 
                                             
 To compile:     g++ -O -Wall overlap.cpp -o overlap
+                (add -fopenmp to use all cores)
 
 To run:         cat net.edg | ./overlap 1 > overlap.txt
                 or, multiplying edge weights by 10000:    cat net.edg | ./overlap  > overlap.txt
+                or, with weighted overlaps:   cat net.edg | ./overlap 0 1 > overlap.txt
+                or, with edge betweenness:    cat net.edg | ./overlap 0 0 1 > overlap.txt
                                                  
 (net.edg is a file where each row contains the values EDGE TAIL EDGECHARACTERISTIC
 (EDGECHARACTERISTIC for example edge weight)
@@ -38,6 +44,7 @@ To run:         cat net.edg | ./overlap 1 > overlap.txt
 #include "../../Containers.H"
 #include "../../Nets.H"
 #include "../NetExtras.H"
+#include "../Betweenness.H"
 
 
 
@@ -58,7 +65,11 @@ int main(int argc, char* argv[]) {
     std::cerr << "Arguments: 1 if overlap values are to be multiplied by 10000 \n";
     std::cerr << "             and rounded to nearest integer (integers are \n";
     std::cerr << "             safer for sorting by overlap).\n";
-    std::cerr << "           0 if overlap values in (0...1)\n\n";
+    std::cerr << "           0 if overlap values in (0...1)\n";
+    std::cerr << "           Optional second argument: 1 to output also\n";
+    std::cerr << "             the weighted overlap as a fourth column.\n";
+    std::cerr << "           Optional third argument: 1 to output also\n";
+    std::cerr << "             the edge betweenness as the last column.\n\n";
     exit(1);
   }
 
@@ -66,6 +77,8 @@ int main(int argc, char* argv[]) {
     if ( atoi(argv[1]) == 1 ) {integerOutput=true;} 
     else {integerOutput=false;}
   }
+  bool weighted = (argc > 2 && atoi(argv[2]) == 1);
+  bool betweenness = (argc > 3 && atoi(argv[3]) == 1);
   
   
   /* Read network from stdin. Using a pointer to a network, since we
@@ -73,6 +86,12 @@ int main(int argc, char* argv[]) {
   std::auto_ptr<NetType> netPointer(readNet<EdgeData>());
   NetType& net = *netPointer;  // Create a reference for easier handling of net.
   
-  outputOverlap(net,integerOutput,true);
+  EdgeOverlaps<NetType> overlaps(net, weighted);
+  if (betweenness) {
+    Betweenness<NetType> bc(net);
+    bc.compute();
+    outputOverlapAndBetweenness(std::cout, overlaps, bc, integerOutput);
+  }
+  else overlaps.write(std::cout, integerOutput, true);
 
 }
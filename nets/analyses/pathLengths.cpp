@@ -58,10 +58,13 @@ typedef SymmNet<EdgeData> NetType;
     std::vector<size_t> order;  for (size_t i=0; i<net.size(); ++i) { order.push_back(i); };  
     shuffle(order,generator);   
     
+    /* The searches share their node labels, so that only the first
+       one has to allocate them. */
+    typename Dijkstrator<NetType>::Workspace space(net.size());
     for (size_t m=0; m<NStartNodes; ++m) {
       size_t startingPoint=order[m]; 
       std::cerr << "\r\rStarting to find shortest paths from node id " << startingPoint << "...\n";
-      Dijkstrator<NetType> paths(net,startingPoint);
+      Dijkstrator<NetType> paths(net,startingPoint,space);
       for (; !paths.finished(); ++paths) {
 	sumlengths += (*paths).getWeight();
 	Ndistances++;
@@ -5,6 +5,7 @@
 
 
 To compile:     g++ -O -Wall strengths.cpp -o strengths
+                (add -fopenmp to use all cores)
 
 To run:         cat net.edg | ./strengths  > strengths.txt
 
@@ -24,6 +25,7 @@ net.edg is a file where each row contains the values SOURCE DEST EDGEDATA.)
 #include "../../Containers.H"
 #include "../../Nets.H"
 #include "../NetExtras.H"
+#include "../Distributions.H"
 
 
 // typedef NDEdgeData<float, float> EdgeData;  
@@ -39,11 +41,11 @@ int main(void) {
   NetType& net = *netPointer;  // Create a reference for easier handling of net.
 
   /* strength of each node and average strength  */
-  float strengthSum=0;
-  for (size_t i=0; i<net.size(); ++i) { 
-    std::cout  << net(i).weight() << "\n";
-    strengthSum += net(i).weight();
-  }
+  NetStatistics<NetType> stats(net, false);
+  stats.writeNodes(std::cout, STRENGTH, false, false);
+
+  double strengthSum=0;
+  for (size_t i=0; i<net.size(); ++i) strengthSum += stats.strength(i);
   std::cerr << "\nAverage strength in the network:  " <<  strengthSum / net.size() << "\n\n";
 
 }
@@ -23,13 +23,19 @@ Note: node indices in the file  namebase_largest.edg may run from 0 to N-1
 
 
 To compile: 
-  g++ -O socmodel4.cpp -o lce2
+  g++ -O -pthread socmodel4.cpp -o lce2
 
 To run: 
   ./lce2 netsize maxRounds p_tri delta netRoundsLimit namebase offset
 
 Example: 
  mkdir testnets;  ./lce2  100 1000 0.3 0.5 3 testnets/net  0
+
+If a file name is given after p_jump, the run of network n is checkpointed
+into that name followed by n every 10 minutes (see lcelib/nets/Checkpoint.H).
+A killed run started again with the same arguments skips the networks whose
+files were already written, and goes on from the checkpoint of the network
+it was building.
   
 Author: Jussi Kumpula
 */
@@ -45,6 +51,7 @@ Author: Jussi Kumpula
 #include "../../../../lcelib/Containers.H"
 #include "../../../../lcelib/Nets.H" 
 #include "../../../../lcelib/Randgens.H"
+#include "../../../../lcelib/nets/Checkpoint.H"
 //#include "../../../../lcelib/misc/KruskalTree2.H"
 // #include <math.h>
 
@@ -195,16 +202,24 @@ void   printParameters(size_t netSize, size_t maxRounds, float p_jump, float p_w
 template <typename NetType, typename Generator>
 void socModel7(NetType & net, Generator & generator, 
 	       const float p_jump, const float p_walk, const float p_tri, const float p_death,
-	       const float delta,  const size_t stepLimit, const size_t maxRounds) {
+	       const float delta,  const size_t stepLimit, const size_t maxRounds,
+	       Checkpoint * checkpoint = 0) {
   
   const size_t netSize = net.size();
   const float w0 = 1.0;
   
  
   NetType net2(netSize); // initialize empty network
+  EdgeBatch<typename NetType::EdgeData> changes; // for merging net2 into net
    
   size_t currentNode, nextNode, secondNode, randNode;
-  for ( size_t rounds=0; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+  size_t rounds=0;
+  if (checkpoint) {   // go on from the checkpoint file, if there is one
+    checkpoint->add(rounds);
+    checkpoint->restore(net, generator);
+  }
+  for ( ; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+    if (checkpoint) checkpoint->tick(net, generator); // net2 and changes are empty here
     
     // net2 should be empty always when starting a new round...
    
@@ -225,12 +240,12 @@ void socModel7(NetType & net, Generator & generator,
 	  
 		nextNode = weighedStep(net, currentNode, generator);
         if ( delta > 0 )
-              net2[currentNode][nextNode] = net2[currentNode][nextNode] + delta; // increase weight in net2
+              net2[currentNode][nextNode] += delta; // increase weight in net2
 	  
     	if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 		    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
             if ( delta > 0 )
-                net2[nextNode][secondNode] = net2[nextNode][secondNode] + delta;   // increase weight in net2
+                net2[nextNode][secondNode] += delta;   // increase weight in net2
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -239,7 +254,7 @@ void socModel7(NetType & net, Generator & generator,
 	      }
 	      else {
                 if ( delta > 0 )
-                        net2[currentNode][secondNode] = net2[currentNode][secondNode] + delta;
+                        net2[currentNode][secondNode] += delta;
 		      }
 		    }
 		  }
@@ -250,20 +265,19 @@ void socModel7(NetType & net, Generator & generator,
       
     // copy changes from net2 to net
     for ( size_t i = 0; i < netSize; ++i) {
-       for (typename NetType::edge_iterator neigh=net2[i].begin(); !neigh.finished(); ++neigh) {
+       for (typename NetType::const_edge_iterator neigh=net2(i).begin(); !neigh.finished(); ++neigh) {
           if ( *neigh > i ) { // take each link only once
-                net[i][*neigh] = net[i][*neigh] + neigh.value(); // add changes
-                neigh.value() = 0; // remove edge so that net2 will eventually be empty
+                changes.add(i, *neigh, neigh.value()); // add changes
           }
        }
     }
+    net.apply(changes); // all at once, grouped by node
+    ClearNet(net2, netSize); // net2 must be empty when the next round starts
       
     // remove nodes  
     for ( size_t i = 0; i < netSize; ++i) { 
       if ( generator.next(1.0) < p_death ) { // delete this node
-		  for (typename NetType::edge_iterator neigh=net[i].begin(); !neigh.finished(); ++neigh) {
-		    neigh.value() = 0;
-		  }
+		  removeEdgesOf(net, i);
       }
     }
    
@@ -272,6 +286,10 @@ void socModel7(NetType & net, Generator & generator,
     }
     
   } // end of rounds loop 
+  if (checkpoint) {
+    checkpoint->wait();
+    checkpoint->clearVariables();
+  }
 }
 
 
@@ -346,37 +364,29 @@ NetType * findLargestComponent(NetType & net)
 
 
 
-int main(int argc, char* argv[]) {
-
-
-  std::string argInfo =  "netSize        - network size (num nodes)\n maxRounds      - how many simulation rounds, use 25000 if don't know otherwise \n p_tri          - triangle probability, this is used to tune the average degree after delta has been fixed \n delta          - increment from initial weight 1; usually values between 0 and 1  \n netRoundsLimit - how many networks to generate \n namebase       - folder path and the base of the network name to be written out \n counterOffset  - normally the program generates network names from zero, but this value can be used to change it \n\nThe code outputs the full network and the largest component in the files \n     namebase_full.edg     namebase_largest.edg  \n\nNote: node indices in the file  namebase_largest.edg may run from 0 to N-1 \n(or counterOffset to N+counterOffset-1) even if the network contains fewer than N nodes.\n\n";
-
-
-  if ( (size_t) argc < (1+1)) { std::cerr << "\nPlease give arguments: \n " << argInfo << "\\n"; exit(1);}
-  const size_t netSize = atoi(argv[1]); // network size (num nodes)
-  const size_t maxRounds = atoi(argv[2]); // how many simulation rounds, use 25000 if don't know otherwise
-  const float p_jump = atof(argv[8]); //0.0005; // amount of random links, 0.0005 is usual but also 0.00025 is fine
-  const float p_walk = 1;   // do not change this!
-  const float p_tri = atof(argv[3]);  // triangle probability, this is used to tune the average degree after delta has been fixed
-  const float p_death = 0.001; // do not change this!
-  const float delta = atof(argv[4]);   // values between 0 and 1 usual
-  const size_t netRoundsLimit = atoi(argv[5]);  // how many networks to generate
-  size_t counterOffset = 0;    
-  if ( argc > 7 ) counterOffset = atoi(argv[7]);    // normally the program generates network names from zero, but this value can be used to change it
-
-  int randseed=time(0) + (int)counterOffset; // some random number 
-  printParameters(netSize, maxRounds, p_jump, p_walk, p_tri, p_death, delta, 0, netRoundsLimit, randseed);
-
-  RandNumGen<> generator(randseed);
-
-
-
-
-
+// generates netRoundsLimit networks into the files namebase<n>_full.edg and namebase<n>_largest.edg.
+// With checkpointBase, the run of network n is checkpointed into the file checkpointBase<n> every
+// checkpointSeconds seconds and every checkpointTicks rounds (none if zero), and the networks whose
+// files were already written are skipped: a killed run started again goes on where it was.
+template <typename Generator>
+void generateNets(Generator & generator, const size_t netSize, const size_t maxRounds,
+		  const float p_jump, const float p_walk, const float p_tri, const float p_death,
+		  const float delta, const size_t netRoundsLimit, const char * namebase,
+		  const size_t counterOffset, const char * checkpointBase = 0,
+		  const double checkpointSeconds = 600, const size_t checkpointTicks = 0) {
 
   // loop over several realisations of the network
   for (size_t netRounds = 0; netRounds < netRoundsLimit; netRounds++) {
     
+    char buffer[100];
+    std::auto_ptr<Checkpoint> checkpoint;
+    if ( checkpointBase ) {
+      sprintf(buffer,"%s%d_largest.edg",namebase, netRounds+counterOffset);
+      if ( std::ifstream(buffer) ) continue; // written before the run was killed
+      sprintf(buffer,"%s%d",checkpointBase, netRounds+counterOffset); // one checkpoint file per network
+      checkpoint.reset(new Checkpoint(buffer, checkpointSeconds, checkpointTicks));
+    }
+
     NetType net(netSize);  // initialize some nodes in the network
     
     // these are needed for non-exponential life times, socmodel8
@@ -388,14 +398,12 @@ int main(int argc, char* argv[]) {
     }
     
     // run the model
-    socModel7(net, generator, p_jump, p_walk, p_tri, p_death, delta, 0, maxRounds);
+    socModel7(net, generator, p_jump, p_walk, p_tri, p_death, delta, 0, maxRounds, checkpoint.get());
 
     std::auto_ptr<NetType> netPointer(findLargestComponent<NetType>(net)); 
     NetType& net2 = *netPointer;  // Create a reference for easier handling of net.
 
-
-    char buffer[100];
-    sprintf(buffer,"%s%d_full.edg",argv[6], netRounds+counterOffset);
+    sprintf(buffer,"%s%d_full.edg",namebase, netRounds+counterOffset);
     
     //      std::ofstream myFile(argv[8] + str);
     std::ofstream myFile(buffer);
@@ -409,7 +417,7 @@ int main(int argc, char* argv[]) {
     myFile.close();
 
 
-    sprintf(buffer,"%s%d_largest.edg",argv[6], netRounds+counterOffset);
+    sprintf(buffer,"%s%d_largest.edg",namebase, netRounds+counterOffset);
     std::ofstream myFile2(buffer);
     if (! myFile2) {
       std::cerr << "Error opening output file\n";
@@ -418,13 +426,49 @@ int main(int argc, char* argv[]) {
     myFile2 << "HEAD\tTAIL\tWEIGHT\n";
     outputEdgesAndWeights2(net2, 0, myFile2);  // largest component
     myFile2.close();
+    if ( checkpoint.get() ) checkpoint->finish(); // this network is done
 
 
   }  // time to build a new network
+}
+
+
+
+
+
+
+// SOCMODEL4_NO_MAIN is for including the model in tests
+#ifndef SOCMODEL4_NO_MAIN
+int main(int argc, char* argv[]) {
+
+
+  std::string argInfo =  "netSize        - network size (num nodes)\n maxRounds      - how many simulation rounds, use 25000 if don't know otherwise \n p_tri          - triangle probability, this is used to tune the average degree after delta has been fixed \n delta          - increment from initial weight 1; usually values between 0 and 1  \n netRoundsLimit - how many networks to generate \n namebase       - folder path and the base of the network name to be written out \n counterOffset  - normally the program generates network names from zero, but this value can be used to change it \n\nThe code outputs the full network and the largest component in the files \n     namebase_full.edg     namebase_largest.edg  \n\nNote: node indices in the file  namebase_largest.edg may run from 0 to N-1 \n(or counterOffset to N+counterOffset-1) even if the network contains fewer than N nodes.\n\n";
+
+
+  if ( (size_t) argc < (1+1)) { std::cerr << "\nPlease give arguments: \n " << argInfo << "\\n"; exit(1);}
+  const size_t netSize = atoi(argv[1]); // network size (num nodes)
+  const size_t maxRounds = atoi(argv[2]); // how many simulation rounds, use 25000 if don't know otherwise
+  const float p_jump = atof(argv[8]); //0.0005; // amount of random links, 0.0005 is usual but also 0.00025 is fine
+  const float p_walk = 1;   // do not change this!
+  const float p_tri = atof(argv[3]);  // triangle probability, this is used to tune the average degree after delta has been fixed
+  const float p_death = 0.001; // do not change this!
+  const float delta = atof(argv[4]);   // values between 0 and 1 usual
+  const size_t netRoundsLimit = atoi(argv[5]);  // how many networks to generate
+  size_t counterOffset = 0;    
+  if ( argc > 7 ) counterOffset = atoi(argv[7]);    // normally the program generates network names from zero, but this value can be used to change it
+
+  int randseed=time(0) + (int)counterOffset; // some random number 
+  printParameters(netSize, maxRounds, p_jump, p_walk, p_tri, p_death, delta, 0, netRoundsLimit, randseed);
+
+  RandNumGen<> generator(randseed);
+
+  generateNets(generator, netSize, maxRounds, p_jump, p_walk, p_tri, p_death, delta,
+	       netRoundsLimit, argv[6], counterOffset, argc > 9 ? argv[9] : 0);
 
 
 
 }
+#endif
 
 
 
@@ -459,16 +503,25 @@ template <typename NetType, typename Generator>
 void socModel8(NetType & net, Generator & generator, 
 	       const float p_jump, const float p_walk, const float p_tri, const float p_death,
 	       const float delta,  const size_t stepLimit, const size_t maxRounds, 
-	       float deathTimes[], const float meanLifeTime, const float stdLife ) {
+	       float deathTimes[], const float meanLifeTime, const float stdLife,
+	       Checkpoint * checkpoint = 0 ) {
   
   const size_t netSize = net.size();
   const float w0 = 1.0;
   
  
   NetType net2(netSize); // initialize empty network
+  EdgeBatch<typename NetType::EdgeData> changes; // for merging net2 into net
    
   size_t currentNode, nextNode, secondNode, randNode;
-  for ( size_t rounds=0; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+  size_t rounds=0;
+  if (checkpoint) {   // go on from the checkpoint file, if there is one
+    checkpoint->add(rounds);
+    for (size_t i = 0; i < netSize; ++i) checkpoint->add(deathTimes[i]);
+    checkpoint->restore(net, generator);
+  }
+  for ( ; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+    if (checkpoint) checkpoint->tick(net, generator); // net2 and changes are empty here
     
     // net2 should be empty always when starting a new round...
    
@@ -489,12 +542,12 @@ void socModel8(NetType & net, Generator & generator,
 	  
 		nextNode = weighedStep(net, currentNode, generator);
         if ( delta > 0 )
-              net2[currentNode][nextNode] = net2[currentNode][nextNode] + delta; // increase weight in net2
+              net2[currentNode][nextNode] += delta; // increase weight in net2
 	  
     	if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 		    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
             if ( delta > 0 )
-                net2[nextNode][secondNode] = net2[nextNode][secondNode] + delta;   // increase weight in net2
+                net2[nextNode][secondNode] += delta;   // increase weight in net2
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -503,7 +556,7 @@ void socModel8(NetType & net, Generator & generator,
 	      }
 	      else {
                 if ( delta > 0 )
-                        net2[currentNode][secondNode] = net2[currentNode][secondNode] + delta;
+                        net2[currentNode][secondNode] += delta;
 		      }
 		    }
 		  }
@@ -514,13 +567,14 @@ void socModel8(NetType & net, Generator & generator,
       
     // copy changes from net2 to net
     for ( size_t i = 0; i < netSize; ++i) {
-       for (typename NetType::edge_iterator neigh=net2[i].begin(); !neigh.finished(); ++neigh) {
+       for (typename NetType::const_edge_iterator neigh=net2(i).begin(); !neigh.finished(); ++neigh) {
           if ( *neigh > i ) { // take each link only once
-                net[i][*neigh] = net[i][*neigh] + neigh.value(); // add changes
-                neigh.value() = 0; // remove edge so that net2 will eventually be empty
+                changes.add(i, *neigh, neigh.value()); // add changes
           }
        }
     }
+    net.apply(changes); // all at once, grouped by node
+    ClearNet(net2, netSize); // net2 must be empty when the next round starts
       
     // remove nodes  
     for ( size_t i = 0; i < netSize; ++i) { 
@@ -528,9 +582,7 @@ void socModel8(NetType & net, Generator & generator,
 	      do {
 	      	deathTimes[i] = rounds + normRandNumber(meanLifeTime, stdLife, generator);
       	  } while ( deathTimes[i] < rounds ); 
-		  for (typename NetType::edge_iterator neigh=net[i].begin(); !neigh.finished(); ++neigh) {
-		    neigh.value() = 0;
-		  }
+		  removeEdgesOf(net, i);
       }
     }
    
@@ -539,6 +591,10 @@ void socModel8(NetType & net, Generator & generator,
     }
     
   } // end of rounds loop 
+  if (checkpoint) {
+    checkpoint->wait();
+    checkpoint->clearVariables();
+  }
 }
 */
 
@@ -587,11 +643,11 @@ void socModel2(NetType & net, Generator & generator,
 	if ( generator.next(1.0) < p_walk ) { // decide whether to do the walk or not
 	  
 	  nextNode = weighedStep(net, currentNode, generator);
-	  net[currentNode][nextNode] = net[currentNode][nextNode] + delta; // increase weight
+	  net[currentNode][nextNode] += delta; // increase weight
 	  
 	  if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 	    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
-	    net[nextNode][secondNode] = net[nextNode][secondNode] + delta;   // increase weight
+	    net[nextNode][secondNode] += delta;   // increase weight
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -600,7 +656,7 @@ void socModel2(NetType & net, Generator & generator,
 		if (  generator.next(1.0) < p_tri ) net[currentNode][secondNode] = w0;
 	      }
 	      else {
-		net[currentNode][secondNode] = net[currentNode][secondNode] + delta;
+		net[currentNode][secondNode] += delta;
 	      }
 	    }
 	  }
@@ -613,9 +669,7 @@ void socModel2(NetType & net, Generator & generator,
       
     for ( size_t i = 0; i < netSize; ++i) { 
       if ( generator.next(1.0) < p_death) {
-	for (typename NetType::edge_iterator neigh=net[i].begin(); !neigh.finished(); ++neigh) {
-	  neigh.value() = 0;
-	}
+	removeEdgesOf(net, i);
       }
     }
 
@@ -668,11 +722,11 @@ void socModel6(NetType & net, NetType & net2, Generator & generator,
 	if ( generator.next(1.0) < p_walk ) { // decide whether to do the walk or not
 	  
 	  nextNode = weighedStep(net, currentNode, generator);
-	  net2[currentNode][nextNode] = net2[currentNode][nextNode] + delta; // increase weight in net2
+	  net2[currentNode][nextNode] += delta; // increase weight in net2
 	  
 	  if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 	    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
-	    net2[nextNode][secondNode] = net2[nextNode][secondNode] + delta;   // increase weight in net2
+	    net2[nextNode][secondNode] += delta;   // increase weight in net2
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -680,7 +734,7 @@ void socModel6(NetType & net, NetType & net2, Generator & generator,
 		if (  generator.next(1.0) < p_tri ) net2[currentNode][secondNode] = w0;
 	      }
 	      else {
-		net2[currentNode][secondNode] = net2[currentNode][secondNode] + delta;
+		net2[currentNode][secondNode] += delta;
 	      }
 	    }
 	  }
@@ -691,9 +745,7 @@ void socModel6(NetType & net, NetType & net2, Generator & generator,
       
     for ( size_t i = 0; i < netSize; ++i) { 
       if ( generator.next(1.0) < p_death) {
-	for (typename NetType::edge_iterator neigh=net2[i].begin(); !neigh.finished(); ++neigh) {
-	  neigh.value() = 0;
-	}
+	removeEdgesOf(net2, i);
       }
     }
 
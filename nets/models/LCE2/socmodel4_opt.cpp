@@ -18,7 +18,7 @@ Note: node indices in the file  namebase_largest.edg may run from 0 to N-1
 
 
 To compile: 
-  g++ -O socmodel4_opt.cpp -o lce2_opt
+  g++ -O -pthread socmodel4_opt.cpp -o lce2_opt
 
 To run: 
   ./lce2_opt netsize maxRounds p_tri delta netRoundsLimit offset
@@ -41,6 +41,7 @@ Author: Jussi Kumpula
 #include "../../../../lcelib/Containers.H"
 #include "../../../../lcelib/Nets.H" 
 #include "../../../../lcelib/Randgens.H"
+#include "../../../../lcelib/nets/Checkpoint.H"
 //#include "../../../../lcelib/misc/KruskalTree2.H"
 // #include <math.h>
 
@@ -191,16 +192,24 @@ void   printParameters(size_t netSize, size_t maxRounds, float p_jump, float p_w
 template <typename NetType, typename Generator>
 void socModel7(NetType & net, Generator & generator, 
 	       const float p_jump, const float p_walk, const float p_tri, const float p_death,
-	       const float delta,  const size_t stepLimit, const size_t maxRounds) {
+	       const float delta,  const size_t stepLimit, const size_t maxRounds,
+	       Checkpoint * checkpoint = 0) {
   
   const size_t netSize = net.size();
   const float w0 = 1.0;
   
  
   NetType net2(netSize); // initialize empty network
+  EdgeBatch<typename NetType::EdgeData> changes; // for merging net2 into net
    
   size_t currentNode, nextNode, secondNode, randNode;
-  for ( size_t rounds=0; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+  size_t rounds=0;
+  if (checkpoint) {   // go on from the checkpoint file, if there is one
+    checkpoint->add(rounds);
+    checkpoint->restore(net, generator);
+  }
+  for ( ; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+    if (checkpoint) checkpoint->tick(net, generator); // net2 and changes are empty here
     
     // net2 should be empty always when starting a new round...
    
@@ -224,13 +233,13 @@ void socModel7(NetType & net, Generator & generator,
 	    {
 	      nextNode = weighedStep(net, currentNode, generator);
 	      if ( delta > 0 ) 
-		net2[currentNode][nextNode] = net2[currentNode][nextNode] + delta; // increase weight in net2
+		net2[currentNode][nextNode] += delta; // increase weight in net2
 	  
 	      if ( net(nextNode).size() > 1 )                                 // if possible, take step avoiding old node
 		{
 		  secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
 		  if ( delta > 0 )
-		    net2[nextNode][secondNode] = net2[nextNode][secondNode] + delta;   // increase weight in net2
+		    net2[nextNode][secondNode] += delta;   // increase weight in net2
 		  
 		  // second neighbor has been found
 		  if (secondNode != currentNode)      // this should be always true... 
@@ -242,7 +251,7 @@ void socModel7(NetType & net, Generator & generator,
 		      else
 			{
 			  if ( delta > 0 )
-			    net2[currentNode][secondNode] = net2[currentNode][secondNode] + delta;
+			    net2[currentNode][secondNode] += delta;
 			}
 		    }
 		}
@@ -254,22 +263,23 @@ void socModel7(NetType & net, Generator & generator,
     // copy changes from net2 to net
     for ( size_t i = 0; i < netSize; ++i)
       {
-	for (typename NetType::edge_iterator neigh=net2[i].begin(); !neigh.finished(); ++neigh)
+	for (typename NetType::const_edge_iterator neigh=net2(i).begin(); !neigh.finished(); ++neigh)
 	  {
 	    if ( *neigh > i )  // take each link only once
 	      {
-		net[i][*neigh] = net[i][*neigh] + neigh.value(); // add changes
-		neigh.value() = 0; // remove edge so that net2 will eventually be empty
+		changes.add(i, *neigh, neigh.value()); // add changes
 	      }
 	  }
       }
+    net.apply(changes); // all at once, grouped by node
+    ClearNet(net2, netSize); // net2 must be empty when the next round starts
       
     // remove nodes  
     for ( size_t i = 0; i < netSize; ++i)
       { 
 	if ( generator.next(1.0) < p_death )  // delete this node
 	  {
-	    for (typename NetType::edge_iterator neigh=net[i].begin(); !neigh.finished(); ++neigh) neigh.value() = 0;
+	    removeEdgesOf(net, i);
 	  }
       }
    
@@ -279,6 +289,10 @@ void socModel7(NetType & net, Generator & generator,
       }
     
   } // end of rounds loop 
+  if (checkpoint) {
+    checkpoint->wait();
+    checkpoint->clearVariables();
+  }
 }
 
 
@@ -453,16 +467,25 @@ template <typename NetType, typename Generator>
 void socModel8(NetType & net, Generator & generator, 
 	       const float p_jump, const float p_walk, const float p_tri, const float p_death,
 	       const float delta,  const size_t stepLimit, const size_t maxRounds, 
-	       float deathTimes[], const float meanLifeTime, const float stdLife ) {
+	       float deathTimes[], const float meanLifeTime, const float stdLife,
+	       Checkpoint * checkpoint = 0 ) {
   
   const size_t netSize = net.size();
   const float w0 = 1.0;
   
  
   NetType net2(netSize); // initialize empty network
+  EdgeBatch<typename NetType::EdgeData> changes; // for merging net2 into net
    
   size_t currentNode, nextNode, secondNode, randNode;
-  for ( size_t rounds=0; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+  size_t rounds=0;
+  if (checkpoint) {   // go on from the checkpoint file, if there is one
+    checkpoint->add(rounds);
+    for (size_t i = 0; i < netSize; ++i) checkpoint->add(deathTimes[i]);
+    checkpoint->restore(net, generator);
+  }
+  for ( ; rounds < maxRounds; ++rounds) {       // run the simulation over many rounds (time steps)
+    if (checkpoint) checkpoint->tick(net, generator); // net2 and changes are empty here
     
     // net2 should be empty always when starting a new round...
    
@@ -483,12 +506,12 @@ void socModel8(NetType & net, Generator & generator,
 	  
 		nextNode = weighedStep(net, currentNode, generator);
         if ( delta > 0 )
-              net2[currentNode][nextNode] = net2[currentNode][nextNode] + delta; // increase weight in net2
+              net2[currentNode][nextNode] += delta; // increase weight in net2
 	  
     	if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 		    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
             if ( delta > 0 )
-                net2[nextNode][secondNode] = net2[nextNode][secondNode] + delta;   // increase weight in net2
+                net2[nextNode][secondNode] += delta;   // increase weight in net2
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -497,7 +520,7 @@ void socModel8(NetType & net, Generator & generator,
 	      }
 	      else {
                 if ( delta > 0 )
-                        net2[currentNode][secondNode] = net2[currentNode][secondNode] + delta;
+                        net2[currentNode][secondNode] += delta;
 		      }
 		    }
 		  }
@@ -508,13 +531,14 @@ void socModel8(NetType & net, Generator & generator,
       
     // copy changes from net2 to net
     for ( size_t i = 0; i < netSize; ++i) {
-       for (typename NetType::edge_iterator neigh=net2[i].begin(); !neigh.finished(); ++neigh) {
+       for (typename NetType::const_edge_iterator neigh=net2(i).begin(); !neigh.finished(); ++neigh) {
           if ( *neigh > i ) { // take each link only once
-                net[i][*neigh] = net[i][*neigh] + neigh.value(); // add changes
-                neigh.value() = 0; // remove edge so that net2 will eventually be empty
+                changes.add(i, *neigh, neigh.value()); // add changes
           }
        }
     }
+    net.apply(changes); // all at once, grouped by node
+    ClearNet(net2, netSize); // net2 must be empty when the next round starts
       
     // remove nodes  
     for ( size_t i = 0; i < netSize; ++i) { 
@@ -522,9 +546,7 @@ void socModel8(NetType & net, Generator & generator,
 	      do {
 	      	deathTimes[i] = rounds + normRandNumber(meanLifeTime, stdLife, generator);
       	  } while ( deathTimes[i] < rounds ); 
-		  for (typename NetType::edge_iterator neigh=net[i].begin(); !neigh.finished(); ++neigh) {
-		    neigh.value() = 0;
-		  }
+		  removeEdgesOf(net, i);
       }
     }
    
@@ -533,6 +555,10 @@ void socModel8(NetType & net, Generator & generator,
     }
     
   } // end of rounds loop 
+  if (checkpoint) {
+    checkpoint->wait();
+    checkpoint->clearVariables();
+  }
 }
 */
 
@@ -581,11 +607,11 @@ void socModel2(NetType & net, Generator & generator,
 	if ( generator.next(1.0) < p_walk ) { // decide whether to do the walk or not
 	  
 	  nextNode = weighedStep(net, currentNode, generator);
-	  net[currentNode][nextNode] = net[currentNode][nextNode] + delta; // increase weight
+	  net[currentNode][nextNode] += delta; // increase weight
 	  
 	  if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 	    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
-	    net[nextNode][secondNode] = net[nextNode][secondNode] + delta;   // increase weight
+	    net[nextNode][secondNode] += delta;   // increase weight
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -594,7 +620,7 @@ void socModel2(NetType & net, Generator & generator,
 		if (  generator.next(1.0) < p_tri ) net[currentNode][secondNode] = w0;
 	      }
 	      else {
-		net[currentNode][secondNode] = net[currentNode][secondNode] + delta;
+		net[currentNode][secondNode] += delta;
 	      }
 	    }
 	  }
@@ -607,9 +633,7 @@ void socModel2(NetType & net, Generator & generator,
       
     for ( size_t i = 0; i < netSize; ++i) { 
       if ( generator.next(1.0) < p_death) {
-	for (typename NetType::edge_iterator neigh=net[i].begin(); !neigh.finished(); ++neigh) {
-	  neigh.value() = 0;
-	}
+	removeEdgesOf(net, i);
       }
     }
 
@@ -662,11 +686,11 @@ void socModel6(NetType & net, NetType & net2, Generator & generator,
 	if ( generator.next(1.0) < p_walk ) { // decide whether to do the walk or not
 	  
 	  nextNode = weighedStep(net, currentNode, generator);
-	  net2[currentNode][nextNode] = net2[currentNode][nextNode] + delta; // increase weight in net2
+	  net2[currentNode][nextNode] += delta; // increase weight in net2
 	  
 	  if ( net(nextNode).size() > 1 ) {                                // if possible, take step avoiding old node
 	    secondNode = weighedStepExcludingOld(net, nextNode, currentNode, generator);
-	    net2[nextNode][secondNode] = net2[nextNode][secondNode] + delta;   // increase weight in net2
+	    net2[nextNode][secondNode] += delta;   // increase weight in net2
 	    
 	    // second neighbor has been found
 	    if (secondNode != currentNode) {     // this should be always true... 
@@ -674,7 +698,7 @@ void socModel6(NetType & net, NetType & net2, Generator & generator,
 		if (  generator.next(1.0) < p_tri ) net2[currentNode][secondNode] = w0;
 	      }
 	      else {
-		net2[currentNode][secondNode] = net2[currentNode][secondNode] + delta;
+		net2[currentNode][secondNode] += delta;
 	      }
 	    }
 	  }
@@ -685,9 +709,7 @@ void socModel6(NetType & net, NetType & net2, Generator & generator,
       
     for ( size_t i = 0; i < netSize; ++i) { 
       if ( generator.next(1.0) < p_death) {
-	for (typename NetType::edge_iterator neigh=net2[i].begin(); !neigh.finished(); ++neigh) {
-	  neigh.value() = 0;
-	}
+	removeEdgesOf(net2, i);
       }
     }
 
@@ -22,6 +22,7 @@
 
 #include "../../../lcelib/nets/NetExtras.H"
 #include "../../../lcelib/nets/Dijkstrator.H"
+#include "../../../lcelib/nets/UnweightedDijk.H"
 
 
 typedef float EdgeData;
@@ -141,6 +142,7 @@ int main(int argc, char* argv[]) {
   size_t distanceLimit = 0;
   int givenNode = 0;
   size_t vertexColor[netSize];
+  UnweighedDijk<NetType>::Workspace space(netSize);
   do {
     nodeSet selectedNodes;
     std::cout << "\nThe visualization was written to the file Sample_0001.eps and can be viewed with the command \n\t\t\tgv Sample_0001.eps\n";
@@ -158,21 +160,18 @@ int main(int argc, char* argv[]) {
       std::cerr << "\nStarting snowball sample from random node " << selectedNode << "\n";
     }
     
-    size_t distance = 0;
     selectedNodes.put( selectedNode );
     vertexColor[selectedNode] = 2; // color code for the starting node of the sample
-    Dijkstrator<NetType> paths(net,selectedNode);  // find paths from the selected begin node
-    do {
-      distance = (size_t) (*paths).getWeight();
-      if (distance <= distanceLimit) {        
-	size_t currentNode =  (size_t)(*paths).getDest();
-	// std::cerr << currentNode << "\t" << distance << "\n";
-	selectedNodes.put( currentNode );
-	if (distance < distanceLimit) vertexColor[currentNode] = 0; // color code for inner nodes in the sample
-	else vertexColor[currentNode] = 1;  // color code for nodes on the boundary of the sample
-      }
-      ++paths;
-    } while (distance <= distanceLimit && !paths.finished() ); 
+    // find paths from the selected begin node, up to distanceLimit steps
+    UnweighedDijk<NetType> paths(net,selectedNode,space,distanceLimit);
+    for (; !paths.finished(); ++paths) {
+      size_t distance = (*paths).getWeight();
+      size_t currentNode = (*paths).getDest();
+      // std::cerr << currentNode << "\t" << distance << "\n";
+      selectedNodes.put( currentNode );
+      if (distance < distanceLimit) vertexColor[currentNode] = 0; // color code for inner nodes in the sample
+      else vertexColor[currentNode] = 1;  // color code for nodes on the boundary of the sample
+    }
     
     std::cerr << "Sample size: " << selectedNodes.size() << "\n";
     // for (nodeSet::iterator i = selectedNodes.begin(); !i.finished(); ++i) std::cerr << *i << " ";